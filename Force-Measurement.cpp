@@ -3,6 +3,9 @@
 //
 // This example demonstrates how to query the HapticMASTER sensors
 // and display the data in an OpenGL window.
+//
+// Built With -DBENCHMARK Against The Loopback In bench/ (See
+// CMakeLists.txt), main() Runs The Hot-Path Benchmark Instead.
 //---------------------------------------------------------------------
 
 #include "HapticAPI2.h"
@@ -557,6 +560,444 @@ void Keyboard(unsigned char ucKey, int iX, int iY)
    }
 }
 
+#ifdef BENCHMARK
+#include <chrono>
+#include <string>
+
+#include "Loopback.h"
+
+//---------------------------------------------------------------------
+//                        B E N C H M A R K S
+//
+// Each Case Times The Work Done On Every Sample Or Frame. The Cheap
+// Reply Handling Cases Do A Whole Frame's Worth Per Op, So They Stay
+// Well Above Timer And Scheduling Noise. Results Are Reported In
+// ns/op And Allocations Per Run And Compared Against A Stored
+// Baseline; A Case Still Slower Than Baseline * (1 + Tolerance) After
+// Being Re-Checked, Or Allocating More Than Its Baseline, Fails The Run.
+//---------------------------------------------------------------------
+const int MaxBenchCases = 16;
+const int BenchRepeats = 9;
+const int BenchRechecks = 2;
+const int BenchWidth = 1024;
+const int BenchHeight = 768;
+
+volatile double BenchSink;
+
+char BenchVecReplies[4][40] = {"[1.234567,-2.345678,3.456789]",
+                               "[-4.567890,5.678901,-6.789012]",
+                               "[7.890123,-8.901234,9.012345]",
+                               "[-10.123456,11.234567,-12.345678]"};
+
+char BenchScalarReplies[4][16] = {"3.500000", "3.600000", "3.700000", "3.800000"};
+
+typedef void (*BenchFunc)(long Iterations);
+
+struct BenchCase
+{
+   const char* Name;
+   BenchFunc Func;
+   long Iterations;
+};
+
+struct BenchResult
+{
+   char Name[64];
+   long Iterations;
+   double NsPerOp;
+   unsigned long Allocs;
+};
+
+// ParseFloatVec Is The Loopback Stand-In From bench/Loopback.cpp, Not
+// The Vendor Function The Example Ships With, So This Case Only
+// Tracks The Stand-In And Says Nothing About The Real Per-Sample Cost.
+void BenchParseFloatVecStandIn(long Iterations)
+{
+   double X, Y, Z;
+   for(long n=0; n<Iterations; n++)
+   {
+      double Sum = 0.0;
+      for(int r=0; r<4; r++)
+      {
+         ParseFloatVec(BenchVecReplies[r], X, Y, Z);
+         Sum += X + Y + Z;
+      }
+      BenchSink = Sum;
+   }
+}
+
+void BenchAtof(long Iterations)
+{
+   for(long n=0; n<Iterations; n++)
+   {
+      double Sum = 0.0;
+      for(int r=0; r<4; r++)
+         Sum += atof(BenchScalarReplies[r]);
+      BenchSink = Sum;
+   }
+}
+
+void BenchErrorCheck(long Iterations)
+{
+   // Display() Checks Each Of Its Four Replies
+   for(long n=0; n<Iterations; n++)
+   {
+      int Errors = 0;
+      for(int r=0; r<4; r++)
+         Errors += (strstr(BenchVecReplies[r], "--- ERROR:") != NULL);
+      BenchSink = Errors;
+   }
+}
+
+void BenchFormatValues(long Iterations)
+{
+   // As In Display(): Every Parameter Is Formatted Once Per Frame
+   for(long n=0; n<Iterations; n++)
+   {
+      int Sample = n % MaxSamples;
+      for(int i=0; i<MaxParams; i++)
+         sprintf(ParamValueStrings[i], "%+08.5f", ParamSamples[i][Sample]);
+      BenchSink = ParamValueStrings[MaxParams-1][1];
+   }
+}
+
+void BenchParamGraphFull(long Iterations)
+{
+   // SampleNr At The End Of The Ring: Single Pass Over The Buffer
+   SampleNr = MaxSampleNr;
+   for(long n=0; n<Iterations; n++)
+      DrawParamGraph(n % MaxParams);
+   glFinish();
+}
+
+void BenchParamGraphWrapped(long Iterations)
+{
+   // SampleNr Mid-Ring: The Buffer Is Drawn In Two Wrapped Halves
+   SampleNr = MaxSamples/2;
+   for(long n=0; n<Iterations; n++)
+      DrawParamGraph(n % MaxParams);
+   glFinish();
+}
+
+// The Loopback DrawWorkspace() Draws Fixed Bounds And Sends No Device
+// Queries, So This Case Covers The Four "get" Commands Of A Frame But
+// Not Whatever Command Traffic The Vendor DrawWorkspace() Adds.
+void BenchDisplay(long Iterations)
+{
+   for(long n=0; n<Iterations; n++)
+   {
+      Display();
+      glFinish();
+   }
+}
+
+BenchCase BenchCases[] = {
+   {"ParseFloatVec-standin-x4", BenchParseFloatVecStandIn, 250000},
+   {"atof-x4",                  BenchAtof,                 250000},
+   {"strstr-error-check-x4",    BenchErrorCheck,           250000},
+   {"sprintf-param-values-x10", BenchFormatValues,         100000},
+   {"DrawParamGraph-full",      BenchParamGraphFull,       2000},
+   {"DrawParamGraph-wrapped",   BenchParamGraphWrapped,    2000},
+   {"Display",                  BenchDisplay,              40},
+};
+
+const int NumBenchCases = sizeof(BenchCases)/sizeof(BenchCases[0]);
+
+//---------------------------------------------------------------------
+//            C H E C K   A L L O C   C O U N T E R
+//
+// Makes Sure Allocations Through operator new, The Standard Library
+// And strdup Reach The Counter. Otherwise allocs/run Would Quietly
+// Read 0 And The Allocation Check Could Never Fail.
+//---------------------------------------------------------------------
+int* volatile BenchProbeArray;
+char* volatile BenchProbeString;
+
+bool CheckAllocCounter(void)
+{
+   unsigned long Before = LoopbackAllocCount();
+   BenchProbeArray = new int[100];
+   delete[] BenchProbeArray;
+   bool NewCounted = LoopbackAllocCount() > Before;
+
+   Before = LoopbackAllocCount();
+   std::string Probe(100, 'x');
+   BenchSink = Probe[BenchProbeArray != NULL];
+   bool StringCounted = LoopbackAllocCount() > Before;
+
+   Before = LoopbackAllocCount();
+   BenchProbeString = strdup("--- ERROR:");
+   free(BenchProbeString);
+   bool StrdupCounted = LoopbackAllocCount() > Before;
+
+   if (!NewCounted || !StringCounted || !StrdupCounted)
+   {
+      printf("--- ERROR: Allocation counter missed%s%s%s\n", NewCounted ? "" : " operator new[]",
+             StringCounted ? "" : " std::string", StrdupCounted ? "" : " strdup");
+      return false;
+   }
+   return true;
+}
+
+//---------------------------------------------------------------------
+//                      R U N   B E N C H   C A S E
+//
+// Times One Repeat Of A Case. The Fastest Repeat Is Kept, Being The
+// Least Disturbed By The Rest Of The System, And Likewise The Lowest
+// Allocation Count: The GL Driver Allocates A Few Times More Or Less
+// From Repeat To Repeat, While An Allocation Added To The Per-Frame
+// Path Raises Every Repeat.
+//---------------------------------------------------------------------
+void RunBenchCase(const BenchCase& Case, BenchResult& Result)
+{
+   unsigned long AllocsBefore = LoopbackAllocCount();
+   std::chrono::steady_clock::time_point Start = std::chrono::steady_clock::now();
+   Case.Func(Case.Iterations);
+   std::chrono::steady_clock::time_point Stop = std::chrono::steady_clock::now();
+   unsigned long Allocs = LoopbackAllocCount() - AllocsBefore;
+
+   double Ns = std::chrono::duration<double, std::nano>(Stop - Start).count() / Case.Iterations;
+   bool First = Result.NsPerOp < 0.0;
+   if (First || Ns < Result.NsPerOp)
+      Result.NsPerOp = Ns;
+   if (First || Allocs < Result.Allocs)
+      Result.Allocs = Allocs;
+}
+
+//---------------------------------------------------------------------
+//                    R U N   B E N C H   C A S E S
+//
+// Repeats Are Interleaved Across The Cases Rather Than Run Back To
+// Back, So A Burst Of Load On The Machine Spoils At Most One Repeat
+// Of Each Case Instead Of Every Repeat Of One Case.
+//---------------------------------------------------------------------
+void RunBenchCases(BenchResult* Results)
+{
+   int i;
+
+   for(i=0; i<NumBenchCases; i++)
+   {
+      snprintf(Results[i].Name, sizeof(Results[i].Name), "%s", BenchCases[i].Name);
+      Results[i].Iterations = BenchCases[i].Iterations;
+      Results[i].NsPerOp = -1.0;
+      Results[i].Allocs = 0;
+
+      // Warm Up Caches And The GL Driver
+      BenchCases[i].Func(BenchCases[i].Iterations/10 + 1);
+   }
+
+   for(int r=0; r<BenchRepeats; r++)
+      for(i=0; i<NumBenchCases; i++)
+         RunBenchCase(BenchCases[i], Results[i]);
+}
+
+//---------------------------------------------------------------------
+//                  R E C H E C K   B E N C H   C A S E S
+//
+// Gives The Cases Flagged In Slow Another BenchRepeats Repeats. Since
+// Only The Fastest Repeat Is Kept, A Case Slowed Down By Passing Load
+// Recovers, While A Real Regression Stays Slow.
+//---------------------------------------------------------------------
+void RecheckBenchCases(BenchResult* Results, const bool* Slow)
+{
+   for(int r=0; r<BenchRepeats; r++)
+      for(int i=0; i<NumBenchCases; i++)
+         if (Slow[i])
+            RunBenchCase(BenchCases[i], Results[i]);
+}
+
+//---------------------------------------------------------------------
+//                     L O A D   B A S E L I N E
+//
+// Reads "<name> <iterations> <ns/op> <allocs/run>" Lines. Returns The
+// Number Of Entries Read, Or -1 If The File Cannot Be Opened.
+//---------------------------------------------------------------------
+int LoadBaseline(const char* FileName, BenchResult* Baseline)
+{
+   FILE* File = fopen(FileName, "r");
+   if (File == NULL)
+      return -1;
+
+   int Count = 0;
+   while (Count < MaxBenchCases &&
+          fscanf(File, "%63s %ld %lf %lu", Baseline[Count].Name, &Baseline[Count].Iterations,
+                 &Baseline[Count].NsPerOp, &Baseline[Count].Allocs) == 4)
+      Count++;
+
+   fclose(File);
+   return Count;
+}
+
+//---------------------------------------------------------------------
+//                     S A V E   B A S E L I N E
+//---------------------------------------------------------------------
+bool SaveBaseline(const char* FileName, const BenchResult* Results, int Count)
+{
+   FILE* File = fopen(FileName, "w");
+   if (File == NULL)
+      return false;
+
+   for(int i=0; i<Count; i++)
+      fprintf(File, "%s %ld %.1f %lu\n", Results[i].Name, Results[i].Iterations, Results[i].NsPerOp, Results[i].Allocs);
+
+   return fclose(File) == 0;
+}
+
+//---------------------------------------------------------------------
+//                      B E N C H   U S A G E
+//---------------------------------------------------------------------
+int BenchUsage(const char* Program)
+{
+   printf("usage: %s [--baseline FILE] [--tolerance PERCENT] [--update-baseline]\n", Program);
+   printf("  --baseline FILE      baseline to compare against (default bench_baseline.txt)\n");
+   printf("  --tolerance PERCENT  allowed ns/op slowdown over the baseline (default 25)\n");
+   printf("  --update-baseline    record this run as the baseline instead of comparing\n");
+   return 2;
+}
+
+//---------------------------------------------------------------------
+//                     R U N   B E N C H M A R K S
+//
+// Returns 0 When Every Case Is Within Its Baseline, 1 On A Regression
+// Or A Missing/Stale Baseline And 2 On Bad Arguments. Baselines Are
+// Machine Specific; Record One With --update-baseline.
+//---------------------------------------------------------------------
+int RunBenchmarks(int argc, char** argv)
+{
+   const char* BaselineFile = "bench_baseline.txt";
+   double Tolerance = 25.0;
+   bool UpdateBaseline = false;
+   int i;
+
+   for(i=1; i<argc; i++)
+   {
+      if (strcmp(argv[i], "--baseline") == 0 && i+1 < argc)
+         BaselineFile = argv[++i];
+      else if (strcmp(argv[i], "--tolerance") == 0 && i+1 < argc)
+      {
+         char* End;
+         Tolerance = strtod(argv[++i], &End);
+         if (End == argv[i] || *End != '\0' || Tolerance < 0.0)
+         {
+            printf("--- ERROR: Invalid tolerance: %s\n", argv[i]);
+            return BenchUsage(argv[0]);
+         }
+      }
+      else if (strcmp(argv[i], "--update-baseline") == 0)
+         UpdateBaseline = true;
+      else
+      {
+         printf("--- ERROR: Unknown or incomplete argument: %s\n", argv[i]);
+         return BenchUsage(argv[0]);
+      }
+   }
+
+   BenchResult Baseline[MaxBenchCases];
+   int NumBaseline = 0;
+   if (!UpdateBaseline)
+   {
+      NumBaseline = LoadBaseline(BaselineFile, Baseline);
+      if (NumBaseline < 0)
+      {
+         printf("--- ERROR: No baseline %s; record one on this machine with --update-baseline\n", BaselineFile);
+         return 1;
+      }
+   }
+
+   if (!CheckAllocCounter() || !LoopbackOpenOffscreen(BenchWidth, BenchHeight))
+      return 1;
+
+   InitOpenGl();
+   Reshape(BenchWidth, BenchHeight);
+
+   // Fill The Ring Buffer So The Graphs Have Real Data
+   for(i=0; i<MaxSamples; i++)
+      Display();
+   glFinish();
+
+   BenchResult Results[MaxBenchCases];
+   RunBenchCases(Results);
+
+   if (UpdateBaseline)
+   {
+      for(i=0; i<NumBenchCases; i++)
+         printf("%-26s %12.1f ns/op %6lu allocs/run\n", Results[i].Name, Results[i].NsPerOp, Results[i].Allocs);
+
+      if (!SaveBaseline(BaselineFile, Results, NumBenchCases))
+      {
+         printf("--- ERROR: Unable to write baseline %s\n", BaselineFile);
+         return 1;
+      }
+      printf("Baseline recorded in %s\n", BaselineFile);
+      return 0;
+   }
+
+   const BenchResult* Bases[MaxBenchCases];
+   for(i=0; i<NumBenchCases; i++)
+   {
+      Bases[i] = NULL;
+      for(int b=0; b<NumBaseline; b++)
+         if (strcmp(Baseline[b].Name, Results[i].Name) == 0 && Baseline[b].Iterations == Results[i].Iterations)
+            Bases[i] = &Baseline[b];
+   }
+
+   // A Case Over The Time Tolerance Is Re-Checked Before It Counts
+   for(int Attempt=0; Attempt<BenchRechecks; Attempt++)
+   {
+      bool Slow[MaxBenchCases];
+      int NumSlow = 0;
+      for(i=0; i<NumBenchCases; i++)
+      {
+         Slow[i] = Bases[i] != NULL && Results[i].NsPerOp > Bases[i]->NsPerOp * (1.0 + Tolerance/100.0);
+         NumSlow += Slow[i];
+      }
+      if (NumSlow == 0)
+         break;
+
+      printf("Re-checking %d benchmark(s) over the tolerance\n", NumSlow);
+      RecheckBenchCases(Results, Slow);
+   }
+
+   int Regressions = 0;
+   printf("%-26s %12s %12s %10s %12s %8s\n", "benchmark", "ns/op", "baseline", "delta", "allocs/run", "baseline");
+
+   for(i=0; i<NumBenchCases; i++)
+   {
+      const BenchResult* Base = Bases[i];
+      bool Listed = false;
+      for(int b=0; b<NumBaseline; b++)
+         Listed = Listed || strcmp(Baseline[b].Name, Results[i].Name) == 0;
+
+      if (Base == NULL)
+      {
+         printf("%-26s %12.1f %12s %10s %12lu %8s  <== %s\n", Results[i].Name, Results[i].NsPerOp, "-", "-",
+                Results[i].Allocs, "-", Listed ? "STALE BASELINE" : "NOT IN BASELINE");
+         Regressions++;
+         continue;
+      }
+
+      double Delta = (Results[i].NsPerOp / Base->NsPerOp - 1.0) * 100.0;
+      bool Slower = Results[i].NsPerOp > Base->NsPerOp * (1.0 + Tolerance/100.0);
+      bool MoreAllocs = Results[i].Allocs > Base->Allocs;
+
+      printf("%-26s %12.1f %12.1f %+9.1f%% %12lu %8lu%s\n", Results[i].Name, Results[i].NsPerOp, Base->NsPerOp,
+             Delta, Results[i].Allocs, Base->Allocs, (Slower || MoreAllocs) ? "  <== REGRESSION" : "");
+
+      if (Slower || MoreAllocs)
+         Regressions++;
+   }
+
+   if (Regressions > 0)
+   {
+      printf("--- ERROR: %d benchmark(s) failed against %s (tolerance %g%%)\n", Regressions, BaselineFile, Tolerance);
+      return 1;
+   }
+
+   printf("All benchmarks within %g%% of %s\n", Tolerance, BaselineFile);
+   return 0;
+}
+#endif
+
 //---------------------------------------------------------------------
 //                              M A I N
 //
@@ -564,6 +1005,10 @@ void Keyboard(unsigned char ucKey, int iX, int iY)
 //---------------------------------------------------------------------
 int main(int argc, char** argv)
 {
+#ifdef BENCHMARK
+   return RunBenchmarks(argc, argv);
+#endif
+
    // Call The Initialize HapticMASTER Function
    dev = haDeviceOpen( IPADDRESS );
 
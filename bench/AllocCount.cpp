@@ -0,0 +1,46 @@
+//---------------------------------------------------------------------
+//                    A L L O C   C O U N T
+//
+// Defines malloc, calloc And realloc In The Executable, Which Makes
+// Them Interpose Process-Wide: Direct Calls, operator new, The
+// Standard Containers, strdup And The GL Driver All Pass Through
+// Here. Each Call Is Counted And Handed On To The glibc Allocator,
+// So The Matching free() Is Left As It Is.
+//---------------------------------------------------------------------
+
+#include <stddef.h>
+
+#include <atomic>
+
+#include "Loopback.h"
+
+extern "C" {
+void* __libc_malloc(size_t Size);
+void* __libc_calloc(size_t Count, size_t Size);
+void* __libc_realloc(void* Ptr, size_t Size);
+}
+
+std::atomic<unsigned long> AllocCount(0);
+
+extern "C" void* malloc(size_t Size)
+{
+   AllocCount.fetch_add(1, std::memory_order_relaxed);
+   return __libc_malloc(Size);
+}
+
+extern "C" void* calloc(size_t Count, size_t Size)
+{
+   AllocCount.fetch_add(1, std::memory_order_relaxed);
+   return __libc_calloc(Count, Size);
+}
+
+extern "C" void* realloc(void* Ptr, size_t Size)
+{
+   AllocCount.fetch_add(1, std::memory_order_relaxed);
+   return __libc_realloc(Ptr, Size);
+}
+
+unsigned long LoopbackAllocCount(void)
+{
+   return AllocCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,280 @@
+//---------------------------------------------------------------------
+//                         L O O P B A C K
+//
+// Linked In Place Of The Vendor HapticAPI Library And GLUT When
+// Building The Benchmark. Device Commands Are Answered From A Small
+// Script, And Drawing Goes To An Offscreen EGL Pbuffer.
+//---------------------------------------------------------------------
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include "HapticAPI2.h"
+#include "HapticMASTER.h"
+#include "Loopback.h"
+
+//---------------------------------------------------------------------
+// S C R I P T E D   R E P L I E S
+//
+// The "get" Queries Issued Once Per Frame Are Answered From These
+// Tables; The Script Moves On One Step Per Frame.
+//---------------------------------------------------------------------
+const int LoopbackFrames = 4;
+int LoopbackFrame = 0;
+
+const char* LoopbackModelPos[LoopbackFrames] = {"[0.012345,-0.023456,0.034567]",
+                                                "[0.045678,-0.056789,0.067890]",
+                                                "[-0.078901,0.089012,-0.090123]",
+                                                "[-0.101234,0.112345,-0.123456]"};
+
+const char* LoopbackModelVel[LoopbackFrames] = {"[0.101010,-0.202020,0.303030]",
+                                                "[-0.404040,0.505050,-0.606060]",
+                                                "[0.707070,-0.808080,0.909090]",
+                                                "[-0.010101,0.020202,-0.030303]"};
+
+const char* LoopbackMeasForce[LoopbackFrames] = {"[1.234567,-2.345678,3.456789]",
+                                                 "[-4.567890,5.678901,-6.789012]",
+                                                 "[7.890123,-8.901234,9.012345]",
+                                                 "[-10.123456,11.234567,-12.345678]"};
+
+const char* LoopbackInertia[LoopbackFrames] = {"3.500000", "3.600000", "3.700000", "3.800000"};
+
+//---------------------------------------------------------------------
+// O F F S C R E E N   C O N T E X T
+//---------------------------------------------------------------------
+EGLDisplay LoopbackDisplay = EGL_NO_DISPLAY;
+EGLSurface LoopbackSurface = EGL_NO_SURFACE;
+int LoopbackWidth = 0;
+int LoopbackHeight = 0;
+
+GLUquadric* LoopbackQuadric = NULL;
+
+// Solid 8x13 Cell Standing In For A GLUT Bitmap Glyph
+const GLubyte LoopbackGlyph[13] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                                   0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+
+//---------------------------------------------------------------------
+//           L O O P B A C K   O P E N   O F F S C R E E N
+//
+// Prefers The Mesa Surfaceless Platform, Which Needs Neither An X
+// Server Nor A GPU, And Falls Back To The Default EGL Display.
+// Mesa's Software Rasterizer Is Kept On The Calling Thread Unless
+// LP_NUM_THREADS Is Already Set, So Timings Do Not Depend On How
+// Its Worker Threads Get Scheduled.
+//---------------------------------------------------------------------
+bool LoopbackOpenOffscreen(int Width, int Height)
+{
+   setenv("LP_NUM_THREADS", "0", 0);
+
+   PFNEGLGETPLATFORMDISPLAYEXTPROC GetPlatformDisplay =
+      (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+   if (GetPlatformDisplay != NULL)
+      LoopbackDisplay = GetPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+   if (LoopbackDisplay == EGL_NO_DISPLAY)
+      LoopbackDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+   EGLint Major, Minor;
+   if (LoopbackDisplay == EGL_NO_DISPLAY || !eglInitialize(LoopbackDisplay, &Major, &Minor)) {
+      printf("--- ERROR: Unable to initialize an EGL display (0x%x)\n", eglGetError());
+      return false;
+   }
+
+   if (!eglBindAPI(EGL_OPENGL_API)) {
+      printf("--- ERROR: EGL display has no desktop OpenGL support (0x%x)\n", eglGetError());
+      return false;
+   }
+
+   const EGLint ConfigAttribs[] = {EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+                                   EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                                   EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+                                   EGL_DEPTH_SIZE, 24,
+                                   EGL_NONE};
+   EGLConfig Config;
+   EGLint NumConfigs = 0;
+   if (!eglChooseConfig(LoopbackDisplay, ConfigAttribs, &Config, 1, &NumConfigs) || NumConfigs == 0) {
+      printf("--- ERROR: No EGL pbuffer config with RGB and depth (0x%x)\n", eglGetError());
+      return false;
+   }
+
+   const EGLint SurfaceAttribs[] = {EGL_WIDTH, Width, EGL_HEIGHT, Height, EGL_NONE};
+   LoopbackSurface = eglCreatePbufferSurface(LoopbackDisplay, Config, SurfaceAttribs);
+   if (LoopbackSurface == EGL_NO_SURFACE) {
+      printf("--- ERROR: Unable to create a %dx%d EGL pbuffer (0x%x)\n", Width, Height, eglGetError());
+      return false;
+   }
+
+   EGLContext Context = eglCreateContext(LoopbackDisplay, Config, EGL_NO_CONTEXT, NULL);
+   if (Context == EGL_NO_CONTEXT || !eglMakeCurrent(LoopbackDisplay, LoopbackSurface, LoopbackSurface, Context)) {
+      printf("--- ERROR: Unable to make an OpenGL context current (0x%x)\n", eglGetError());
+      return false;
+   }
+
+   LoopbackWidth = Width;
+   LoopbackHeight = Height;
+   LoopbackQuadric = gluNewQuadric();
+   return true;
+}
+
+//---------------------------------------------------------------------
+//                     H A P T I C   A P I
+//---------------------------------------------------------------------
+long haDeviceOpen(const char*)
+{
+   return 1;
+}
+
+int haDeviceClose(long)
+{
+   return HARET_SUCCESS;
+}
+
+int haSendCommand(long, const char* Command, char* Response)
+{
+   const char* Reply = "\"OK\"";
+
+   if (strcmp(Command, "get modelpos") == 0)
+      Reply = LoopbackModelPos[LoopbackFrame];
+   else if (strcmp(Command, "get modelvel") == 0)
+      Reply = LoopbackModelVel[LoopbackFrame];
+   else if (strcmp(Command, "get measforce") == 0)
+      Reply = LoopbackMeasForce[LoopbackFrame];
+   else if (strcmp(Command, "get inertia") == 0)
+   {
+      // Last Query Of A Frame, Move The Script On
+      Reply = LoopbackInertia[LoopbackFrame];
+      LoopbackFrame = (LoopbackFrame + 1) % LoopbackFrames;
+   }
+
+   strcpy(Response, Reply);
+   return HARET_SUCCESS;
+}
+
+int haSendCommand(long Dev, const char* Command, double, char* Response)
+{
+   return haSendCommand(Dev, Command, Response);
+}
+
+int haSendCommand(long Dev, const char* Command, double, double, double, char* Response)
+{
+   return haSendCommand(Dev, Command, Response);
+}
+
+//---------------------------------------------------------------------
+//                E X A M P L E   H E L P E R S
+//---------------------------------------------------------------------
+void InitializeDevice(long Dev)
+{
+   char Response[100];
+   haSendCommand(Dev, "set state init", Response);
+}
+
+void DrawAxes(void)
+{
+   glBegin(GL_LINES);
+      glVertex3f(0.0, 0.0, 0.0);
+      glVertex3f(0.1, 0.0, 0.0);
+      glVertex3f(0.0, 0.0, 0.0);
+      glVertex3f(0.0, 0.1, 0.0);
+      glVertex3f(0.0, 0.0, 0.0);
+      glVertex3f(0.0, 0.0, 0.1);
+   glEnd();
+}
+
+//---------------------------------------------------------------------
+//                   D R A W   W O R K S P A C E
+//
+// Draws The Workspace Bounds As A Wire Box. The Bounds Are Fixed
+// Here Rather Than Queried, So The Frame Issues No Extra Commands.
+//---------------------------------------------------------------------
+void DrawWorkspace(long, int)
+{
+   const double Min[3] = {-0.19, -0.25, -0.20};
+   const double Max[3] = { 0.19,  0.25,  0.20};
+   int i;
+
+   for(i=0; i<2; i++)
+   {
+      double Z = i ? Max[2] : Min[2];
+      glBegin(GL_LINE_LOOP);
+         glVertex3f(Min[0], Min[1], Z);
+         glVertex3f(Max[0], Min[1], Z);
+         glVertex3f(Max[0], Max[1], Z);
+         glVertex3f(Min[0], Max[1], Z);
+      glEnd();
+   }
+
+   glBegin(GL_LINES);
+      for(i=0; i<4; i++)
+      {
+         double X = (i & 1) ? Max[0] : Min[0];
+         double Y = (i & 2) ? Max[1] : Min[1];
+         glVertex3f(X, Y, Min[2]);
+         glVertex3f(X, Y, Max[2]);
+      }
+   glEnd();
+}
+
+//---------------------------------------------------------------------
+//                   P A R S E   F L O A T   V E C
+//
+// Parses A "[x,y,z]" Reply. Returns false If Any Value Is Missing.
+//---------------------------------------------------------------------
+bool ParseFloatVec(const char* Response, double& X, double& Y, double& Z)
+{
+   double* Values[3] = {&X, &Y, &Z};
+   const char* Cursor = strchr(Response, '[');
+
+   if (Cursor == NULL)
+      return false;
+
+   for(int i=0; i<3; i++)
+   {
+      char* End;
+      *Values[i] = strtod(Cursor + 1, &End);
+      if (End == Cursor + 1)
+         return false;
+      Cursor = End;
+   }
+   return true;
+}
+
+//---------------------------------------------------------------------
+//                       G L U T   S U B S E T
+//
+// The Window Management Calls Are Only Reached From The Example's
+// Interactive main() And Do Nothing Here.
+//---------------------------------------------------------------------
+void glutInit(int*, char**) {}
+void glutInitDisplayMode(unsigned int) {}
+void glutInitWindowSize(int, int) {}
+int glutCreateWindow(const char*) { return 1; }
+void glutReshapeFunc(void (*)(int, int)) {}
+void glutDisplayFunc(void (*)(void)) {}
+void glutKeyboardFunc(void (*)(unsigned char, int, int)) {}
+void glutMainLoop(void) {}
+void glutPostRedisplay(void) {}
+
+int glutGet(GLenum State)
+{
+   if (State == GLUT_WINDOW_WIDTH)
+      return LoopbackWidth;
+   if (State == GLUT_WINDOW_HEIGHT)
+      return LoopbackHeight;
+   return 0;
+}
+
+void glutSwapBuffers(void)
+{
+   eglSwapBuffers(LoopbackDisplay, LoopbackSurface);
+}
+
+void glutSolidSphere(GLdouble Radius, GLint Slices, GLint Stacks)
+{
+   gluSphere(LoopbackQuadric, Radius, Slices, Stacks);
+}
+
+void glutBitmapCharacter(void*, int)
+{
+   glBitmap(8, 13, 0.0f, 2.0f, 8.0f, 0.0f, LoopbackGlyph);
+}
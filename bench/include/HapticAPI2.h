@@ -0,0 +1,26 @@
+//---------------------------------------------------------------------
+//          H A P T I C   A P I   2   ( L O O P B A C K )
+//
+// Stand-In For The Vendor HapticAPI2.h Used By The Benchmark Build.
+// It Declares The Subset Of The HapticAPI The Examples Call; The
+// Definitions Live In bench/Loopback.cpp, Which Is Linked In Place
+// Of The Vendor Library.
+//---------------------------------------------------------------------
+#ifndef HAPTICAPI2_LOOPBACK_H
+#define HAPTICAPI2_LOOPBACK_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HARET_SUCCESS 0
+#define HARET_ERROR -1
+
+long haDeviceOpen(const char* IPAddress);
+int haDeviceClose(long Dev);
+
+int haSendCommand(long Dev, const char* Command, char* Response);
+int haSendCommand(long Dev, const char* Command, double Value, char* Response);
+int haSendCommand(long Dev, const char* Command, double X, double Y, double Z, char* Response);
+
+#endif
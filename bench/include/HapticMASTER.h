@@ -0,0 +1,57 @@
+//---------------------------------------------------------------------
+//          H A P T I C   M A S T E R   ( L O O P B A C K )
+//
+// Stand-In For The Vendor HapticMASTER.h Used By The Benchmark Build.
+// Besides The Example Helpers It Declares The Part Of GLUT The
+// Examples Use, So The Benchmark Renders Through Its Own Offscreen
+// Context Instead Of A GLUT Window.
+//---------------------------------------------------------------------
+#ifndef HAPTICMASTER_LOOPBACK_H
+#define HAPTICMASTER_LOOPBACK_H
+
+#include <GL/gl.h>
+#include <GL/glu.h>
+
+//---------------------------------------------------------------------
+// G L U T   S U B S E T
+//---------------------------------------------------------------------
+#define GLUT_RGB                0x0000
+#define GLUT_DOUBLE             0x0002
+#define GLUT_DEPTH              0x0010
+#define GLUT_WINDOW_WIDTH       0x0066
+#define GLUT_WINDOW_HEIGHT      0x0067
+#define GLUT_BITMAP_8_BY_13     ((void*)3)
+
+void glutInit(int* argcp, char** argv);
+void glutInitDisplayMode(unsigned int Mode);
+void glutInitWindowSize(int Width, int Height);
+int glutCreateWindow(const char* Title);
+void glutReshapeFunc(void (*Func)(int Width, int Height));
+void glutDisplayFunc(void (*Func)(void));
+void glutKeyboardFunc(void (*Func)(unsigned char Key, int X, int Y));
+void glutMainLoop(void);
+int glutGet(GLenum State);
+void glutPostRedisplay(void);
+void glutSwapBuffers(void);
+void glutSolidSphere(GLdouble Radius, GLint Slices, GLint Stacks);
+void glutBitmapCharacter(void* Font, int Character);
+
+//---------------------------------------------------------------------
+// E X A M P L E   H E L P E R S
+//---------------------------------------------------------------------
+class Vector3d
+{
+public:
+   Vector3d(double X = 0.0, double Y = 0.0, double Z = 0.0) : x(X), y(Y), z(Z) {}
+
+   double x;
+   double y;
+   double z;
+};
+
+void InitializeDevice(long Dev);
+void DrawAxes(void);
+void DrawWorkspace(long Dev, int Mode);
+bool ParseFloatVec(const char* Response, double& X, double& Y, double& Z);
+
+#endif
@@ -0,0 +1,17 @@
+//---------------------------------------------------------------------
+//                         L O O P B A C K
+//
+// Extras Of The Benchmark Build That Have No Vendor Counterpart.
+//---------------------------------------------------------------------
+#ifndef LOOPBACK_H
+#define LOOPBACK_H
+
+// Creates An Offscreen OpenGL Context Of The Given Size And Makes It
+// Current. No Display Connection Is Needed. Returns false On Failure.
+bool LoopbackOpenOffscreen(int Width, int Height);
+
+// Number Of malloc/calloc/realloc Calls Made So Far Anywhere In The
+// Process, Including operator new (See bench/AllocCount.cpp).
+unsigned long LoopbackAllocCount(void);
+
+#endif